@@ -1,4 +1,6 @@
 var child = require('child_process'),
+    fs = require('fs'),
+    path = require('path'),
     exec = child.exec,
     BIN = './node_modules/.bin/';
 
@@ -69,7 +71,27 @@ module.exports = function(grunt) {
     });
   });
   
+  grunt.registerTask('run_benchmark', 'build and run the bridge benchmark', function() {
+    // use a hyperloop checkout next to this one (the same way lib/dev.js finds
+    // hyperloop-common) or else the hyperloop CLI on the PATH, and point it at
+    // this package so the benchmark is built from this tree
+    var done = this.async(),
+      local = path.join(__dirname, '..', 'hyperloop', 'bin', 'hyperloop'),
+      hyperloop = fs.existsSync(local) ? '"' + process.execPath + '" "' + local + '"' : 'hyperloop',
+      cmd = hyperloop + ' benchmark --platform=java --platform-dir="' + __dirname + '" --src=benchmarks/bridge --dest=build/benchmark';
+
+    grunt.log.debug(cmd);
+    var p = exec(cmd, function(err) {
+      if (err) { grunt.fail.fatal(err); }
+      grunt.log.ok('benchmark report generated to "./build/benchmark/benchmark.json"');
+      done();
+    });
+    p.stdout.pipe(process.stdout);
+    p.stderr.pipe(process.stderr);
+  });
+
   grunt.registerTask('test', test_tasks);
+  grunt.registerTask('benchmark', ['run_benchmark']);
   grunt.registerTask('coverage', ['clean:test','run_coverage']);
   grunt.registerTask('default', 'test');
 };
\ No newline at end of file
@@ -0,0 +1,146 @@
+"use hyperloop"
+
+/**
+ * JS <-> Java bridge benchmark. each scenario prints one HL_BENCHMARK line
+ * that is collected into a JSON report by the benchmark command.
+ */
+var WARMUP = 1000,
+	MIN_ITERATIONS = 1000,
+	MIN_ELAPSED_NS = 100 * 1e6;
+
+Hyperloop.defineClass(BenchmarkRunnable)
+	.package('com.test.benchmark')
+	.extends('java.lang.Object')
+	.implements('java.lang.Runnable')
+	.method({
+		attributes: ['public'],
+		name: 'run',
+		returns: 'void',
+		arguments: [],
+		action: function() {
+		}
+	}).build();
+
+function stats() {
+	return typeof(Hyperloop_Java_Stats)==='function' ? Hyperloop_Java_Stats() : null;
+}
+
+function now() {
+	return java.lang.System.nanoTime();
+}
+
+function run(fn, iterations) {
+	var started = now();
+	for (var i = 0; i < iterations; i++) {
+		fn();
+	}
+	return now() - started;
+}
+
+/**
+ * doubles the iterations until a run takes at least MIN_ELAPSED_NS so the
+ * clock resolution and call overhead of nanoTime() don't dominate the result
+ */
+function bench(name, fn) {
+	var iterations = MIN_ITERATIONS, before, after, elapsed;
+	try {
+		run(fn, WARMUP);
+		for (;;) {
+			before = stats();
+			elapsed = run(fn, iterations);
+			after = stats();
+			if (elapsed >= MIN_ELAPSED_NS) {
+				break;
+			}
+			iterations *= 2;
+		}
+		console.log('HL_BENCHMARK '+JSON.stringify({
+			name: name,
+			iterations: iterations,
+			ns_per_call: elapsed / iterations,
+			allocations: before && after ? after.nativeObjects - before.nativeObjects : null,
+			global_refs: after ? after.globalRefs : null,
+			global_refs_delta: before && after ? after.globalRefs - before.globalRefs : null,
+			identity_cache_hits: before && after ? after.identityCacheHits - before.identityCacheHits : null
+		}));
+	} catch (E) {
+		console.log('HL_BENCHMARK '+JSON.stringify({name: name, error: String(E)}));
+	}
+}
+
+var s = new java.lang.String('hello'),
+	csv = new java.lang.String('a,b,c'),
+	ints = [1, 2, 3],
+	runnable = new com.test.benchmark.BenchmarkRunnable();
+
+// micro scenarios
+bench('static_call', function() {
+	java.lang.System.currentTimeMillis();
+});
+
+bench('instance_call', function() {
+	s.length();
+});
+
+bench('overload_explicit', function() {
+	Hyperloop.method(s, 'indexOf(java.lang.String)').call('l');
+});
+
+bench('overload_dispatch_string', function() {
+	s.indexOf('l');
+});
+
+bench('overload_dispatch_int', function() {
+	s.indexOf(108);
+});
+
+bench('constructor', function() {
+	Hyperloop.method('java.lang.String', '<init>(java.lang.String)').call('hello');
+});
+
+bench('string_to_js', function() {
+	s.toString();
+});
+
+bench('string_to_java', function() {
+	s.concat('world');
+});
+
+bench('char_array', function() {
+	s.toCharArray();
+});
+
+bench('byte_array', function() {
+	s.getBytes();
+});
+
+bench('object_array', function() {
+	csv.split(',');
+});
+
+// Arrays.hashCode is overloaded for every array type, so pick int[] explicitly
+bench('array_argument', function() {
+	Hyperloop.method('java.util.Arrays', 'hashCode(int[])').call(ints);
+});
+
+bench('callback', function() {
+	runnable.run();
+});
+
+bench('exception', function() {
+	try {
+		Hyperloop.method('java.lang.Integer', '<init>(java.lang.String)').call('no way');
+	} catch (E) {
+	}
+});
+
+// macro scenarios
+bench('object_churn', function() {
+	new java.lang.Object().hashCode();
+});
+
+bench('method_chain', function() {
+	s.getClass().getName().charAt(1);
+});
+
+console.log('HL_BENCHMARK_END '+JSON.stringify(stats()));
@@ -0,0 +1,102 @@
+/*
+ * Benchmark runner
+ */
+var path = require('path'),
+	fs = require('fs'),
+	os = require('os'),
+	hyperloop = require('../../lib/dev').require('hyperloop-common'),
+	log = hyperloop.log,
+	Command = hyperloop.Command,
+	spawn = require('child_process').spawn,
+	buildlib = require('../../lib/buildlib');
+
+/**
+ * compile the app in --src into --dest with the benchmark counters enabled.
+ * this goes through the hyperloop CLI that is running this command, pointed
+ * at this package with --platform-dir so the generated sources and the native
+ * library are built by this tree's lib/library.js and lib/buildlib.js rather
+ * than by whichever hyperloop-java the CLI has installed.
+ */
+function compile(options, callback) {
+	var args = [
+			process.argv[1],
+			'compile',
+			'--platform='+(options.platform || 'java'),
+			'--platform-dir='+path.join(__dirname,'..','..'),
+			'--src='+path.resolve(options.src),
+			'--dest='+path.resolve(options.dest),
+			'--benchmark'
+		];
+	options['identity-cache'] && args.push('--identity-cache='+options['identity-cache']);
+	options.debug && args.push('--debug');
+	log.debug(process.execPath+' '+args.join(' '));
+	var p = spawn(process.execPath, args, {stdio:'inherit'});
+	p.on('close',function(exitCode){
+		callback(exitCode===0 ? null : 'compile exited with code '+exitCode);
+	});
+}
+
+module.exports = new Command(
+	'benchmark',
+	'Compile and run the application as a benchmark in the Java VM and report the results as JSON',
+	[
+	],
+	function(state,done) {
+		try {
+			var options = state.options,
+				outdir = path.resolve(options.dest),
+				reportfile = path.resolve(options.report || path.join(outdir,'benchmark.json')),
+				report = {
+					platform: os.platform(),
+					arch: os.arch(),
+					timestamp: new Date().toISOString(),
+					identity_cache: parseInt(options['identity-cache'] || 0, 10),
+					scenarios: [],
+					totals: null
+				},
+				stderr = '',
+				pending = '';
+
+			function collect(line) {
+				var m = /^HL_BENCHMARK(_END)? (.*)$/.exec(line.trim());
+				if (!m) {
+					line.trim() && log.debug(line.trim());
+					return;
+				}
+				try {
+					if (m[1]) {
+						report.totals = JSON.parse(m[2]);
+					} else {
+						report.scenarios.push(JSON.parse(m[2]));
+					}
+				} catch (E) {
+					log.warn('invalid benchmark result: '+m[2]);
+				}
+			}
+
+			compile(options, function(err){
+				if (err) { return done(err); }
+				buildlib.runApp(outdir, function(buf){
+					var lines = (pending + buf.toString()).split(/\n/);
+					pending = lines.pop();
+					lines.forEach(collect);
+				}, function(buf){
+					stderr += buf.toString();
+				}, function(err, exitCode){
+					if (err) { return done(err); }
+					pending && collect(pending);
+					if (exitCode !== 0 || !report.scenarios.length) {
+						return done(stderr || 'benchmark exited with code '+exitCode+' and no results');
+					}
+					var json = JSON.stringify(report, null, 2);
+					fs.writeFileSync(reportfile, json);
+					log.info('benchmark report written to '+reportfile);
+					console.log(json);
+					done();
+				});
+			});
+		} catch (E) {
+			done(E);
+		}
+	}
+);
@@ -19,6 +19,7 @@ var exec = require('child_process').exec,
 
 exports.library = library;
 exports.getJavaHome = getJavaHome;
+exports.runApp = runApp;
 
 function getJavaFrameworkHeadersForOSX(callback) {
 	// Search for include dir, then look into system library
@@ -137,3 +138,34 @@ function library(staticlib, debug, jobs, sources, cflags, linkflags, libdir, out
 	});
 
 }
+
+/**
+ * compile the java runner into outdir and run the app library built there
+ * in the local Java VM. stdout/stderr data is passed to the handlers as it
+ * arrives and callback is called with the exit code once the VM exits.
+ */
+function runApp(outdir, onStdout, onStderr, callback) {
+	getJavaHome(function(err,javahome){
+		if (err) return callback(err);
+		var javac = path.join(javahome,'bin','javac'),
+			java = path.join(javahome,'bin','java'),
+			cmd = javac+' -g -d "'+outdir+'" app.java org/appcelerator/hyperloop/Hyperloop.java',
+			cwd = process.cwd();
+
+		process.chdir(path.join(__dirname,'..','templates','java'));
+		log.debug(cmd);
+
+		exec(cmd, function(err){
+			process.chdir(cwd);
+			if (err) return callback(err);
+			cmd = java + ' -Djava.library.path="'+outdir+'" -cp "'+outdir+'" app';
+			log.debug(cmd);
+			var p = spawn(java,['-Djava.library.path='+outdir,'-cp',outdir,'app']);
+			p.stdout.on('data',onStdout);
+			p.stderr.on('data',onStderr);
+			p.on('close',function(exitCode){
+				callback(null, exitCode);
+			});
+		});
+	});
+}
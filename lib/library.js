@@ -23,6 +23,7 @@ exports.compileLibrary = compileLibrary;
 exports.prepareLibrary = prepareLibrary;
 exports.generateLibrary = generateLibrary;
 exports.generateApp = generateApp;
+exports.getCFlags = getCFlags;
 exports.prepareArchitecture = prepareArchitecture;
 exports.prepareClass = prepareClass;
 exports.prepareFunction = prepareFunction;
@@ -253,7 +254,23 @@ function generateLibrary (options, arch_results, settings, callback) {
 		libfile = path.join(options.dest, options.libname || getDefaultLibraryName()),
 		arch = options.arch || options.platform,
 		sources = arch_results[arch];
-	buildlib.library(true, options.debug, options.jobs, sources, options.cflags, options.linkflags, options.dest, builddir, libfile, callback);
+	buildlib.library(true, options.debug, options.jobs, sources, getCFlags(options), options.linkflags, options.dest, builddir, libfile, callback);
+}
+
+/**
+ * return the compiler flags for the runtime and generated sources. --benchmark
+ * compiles in the bridge counters and --identity-cache=<n> sizes the Java
+ * object identity cache (see templates/hyperloop.cpp)
+ */
+function getCFlags(options) {
+	var cflags = (options.cflags || []).slice();
+	if (options.benchmark) {
+		cflags.push('-DHL_JAVA_BENCHMARK');
+	}
+	if (options['identity-cache']) {
+		cflags.push('-DHL_JAVA_IDENTITY_CACHE_SIZE='+parseInt(options['identity-cache'],10));
+	}
+	return cflags;
 }
 
 function generateApp (options, arch_results, settings, callback) {
@@ -261,7 +278,7 @@ function generateApp (options, arch_results, settings, callback) {
 		libfile = path.join(options.dest, options.libname || getDefaultAppName()),
 		arch = options.arch || options.platform,
 		sources = arch_results[arch];
-	buildlib.library(false, options.debug, options.jobs, sources, options.cflags, options.linkflags, options.dest, builddir, libfile, callback);
+	buildlib.library(false, options.debug, options.jobs, sources, getCFlags(options), options.linkflags, options.dest, builddir, libfile, callback);
 }
 
 function addDefaultImports(state) {
@@ -428,7 +445,11 @@ function generateMethod(options, metabase, state, indent, varname, classname, me
 		var rpreamble = [],
 			declare = [],
 			classObj = typelib.resolveType(classname),
-			resultCode = (methodType.isInstanceType() ? classObj : methodType).toJSBody('result', rpreamble, cleanup, declare);
+			resultType = methodType.isInstanceType() ? classObj : methodType,
+			// constructor results are new objects, so they're added to the identity cache without a lookup
+			resultCode = methodType.isInstanceType() || method.name === '<init>' ?
+				resultType.toNewInstanceJSBody('result', rpreamble, cleanup, declare) :
+				resultType.toJSBody('result', rpreamble, cleanup, declare);
 		returnBlock = 'return ' + resultCode + ';';
 		rpreamble.length && (methodBlock+='\n'+indent+rpreamble.join('\n'+indent));
 		declare.length && (declare.filter(function(c) {return !/instancetype/.test(c);}).forEach(function(d) { addExtern (state, d); }));
@@ -550,10 +571,13 @@ function generateJNICustomClassImpl(options, metabase, state, classname, code, e
 				code.push('\tauto func = (JSValueRef)action;');
 				code.push('\tJSValueRef * exception = (JSValueRef*)excep;');
 				code.push('\tauto ctx = HyperloopGlobalContext();');
-				code.push('\tauto instance = JSValueToObject(ctx, '+toJSValue+'(ctx, obj, exception), exception);');
+				code.push('\tauto instance = JSValueToObject(ctx, HyperloopJavaObjectToJSValue(ctx, obj, '+toJSValue+', exception), exception);');
 				code.push('\tauto superProperty = JSStringCreateWithUTF8CString(\"super\");');
-				code.push('\tauto superObj = '+superClassToJSValue+'(ctx, obj, exception);'); // this.super
-				code.push('\tJSObjectSetProperty(ctx, instance, superProperty, superObj, kJSPropertyAttributeReadOnly|kJSPropertyAttributeDontEnum|kJSPropertyAttributeDontDelete, exception);');
+				code.push('\tif (!JSObjectHasProperty(ctx, instance, superProperty))'); // cached wrappers keep their this.super
+				code.push('\t{');
+				code.push('\t\tauto superObj = HyperloopJavaObjectToJSValue(ctx, obj, '+superClassToJSValue+', exception);');
+				code.push('\t\tJSObjectSetProperty(ctx, instance, superProperty, superObj, kJSPropertyAttributeReadOnly|kJSPropertyAttributeDontEnum|kJSPropertyAttributeDontDelete, exception);');
+				code.push('\t}');
 				code.push('\tJSStringRelease(superProperty);');
 				if (method.args.length > 0) {
 					code.push('\tJSValueRef args[] = {'+args.join(',')+'};');
@@ -1007,6 +1031,19 @@ function generateMain (options, state, obj, symbols, symbolnames, externs, clean
 			});
 		});
 	});
+
+	// bridge counters (see templates/hyperloop.cpp), only exposed to apps compiled by the benchmark command
+	if (options.benchmark) {
+		var statsname = 'Hyperloop_Java_Stats';
+		symbolnames.push(statsname);
+		symbols.push('// '+statsname);
+		symbols.push('auto '+statsname+'Property = JSStringCreateWithUTF8CString("'+statsname+'");');
+		symbols.push('auto '+statsname+'Fn = JSObjectMakeFunctionWithCallback(ctx,'+statsname+'Property,'+statsname+');');
+		symbols.push('JSObjectSetProperty(ctx,object,'+statsname+'Property,'+statsname+'Fn,kJSPropertyAttributeReadOnly|kJSPropertyAttributeDontEnum|kJSPropertyAttributeDontDelete,nullptr);');
+		cleanup.push('JSStringRelease('+statsname+'Property);');
+		symbols.push('');
+		externs.push('JSValueRef '+statsname+'(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception);');
+	}
 }
 
 /**
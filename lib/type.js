@@ -227,7 +227,30 @@ JavaType.prototype.toJSBody = function(varname, preamble, cleanup, declare) {
 		}
 		return 'HyperloopMakeJavaStringFromJChar(ctx,'+varname+','+this._length+',exception)';
 	}
-	return this.$super.toJSBody.call(this, varname, preamble, cleanup, declare);
+	return this.toIdentityJSBody('HyperloopJavaObjectToJSValue', varname, preamble, cleanup, declare);
+};
+
+/**
+ * a Java object that was just created can't have a JS wrapper yet, so skip the
+ * identity lookup but still register the new wrapper
+ */
+JavaType.prototype.toNewInstanceJSBody = function(varname, preamble, cleanup, declare) {
+	return this.toIdentityJSBody('HyperloopJavaNewObjectToJSValue', varname, preamble, cleanup, declare);
+};
+
+/**
+ * route Java objects through the identity cache (see templates/hyperloop.cpp) so
+ * the same Java object gets the same JS wrapper (i.e. method chains returning this)
+ */
+JavaType.prototype.toIdentityJSBody = function(fn, varname, preamble, cleanup, declare) {
+	var body = this.$super.toJSBody.call(this, varname, preamble, cleanup, declare);
+	if (this._nativetype == SuperClass.NATIVE_OBJECT) {
+		var name = this.toJSValueName(),
+			extern = 'EXPORTAPI JSValueRef '+name+'(JSContextRef,jobject,JSValueRef *);';
+		declare && declare.indexOf(extern) < 0 && declare.push(extern);
+		return fn+'(ctx,'+varname+','+name+',exception)';
+	}
+	return body;
 };
 
 JavaType.prototype._parse = function(metabase) {
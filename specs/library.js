@@ -0,0 +1,81 @@
+var should = require('should'),
+	path = require('path'),
+	typelib = require('../lib/dev').require('hyperloop-common').compiler.type,
+	library = require('../lib/library');
+
+describe('Java library generation', function(){
+
+	var metabase = {
+		classes: {
+			"java.lang.Object": {
+				methods: {},
+				properties: {}
+			},
+			"com.test.app.MyClass": {
+				superClass: 'java.lang.Object',
+				methods: {},
+				properties: {}
+			}
+		}
+	};
+
+	before(function(){
+		typelib.reset();
+		typelib.metabase = null;
+		typelib.platform = null;
+	});
+
+	afterEach(function(){
+		typelib.reset();
+		typelib.metabase = null;
+		typelib.platform = null;
+	});
+
+	beforeEach(function(){
+		typelib.platform = path.join(__dirname,'..');
+		typelib.metabase = metabase;
+	});
+
+	it('constructor result is added to the identity cache without a lookup',function() {
+		var state = {externs:[]},
+			method = {name:'<init>', instance:false, args:[], returnType:'java.lang.Object', signature:'()V'},
+			code = library.generateMethod({platform:'java'}, metabase, state, '\t', 'object', 'java.lang.Object', method, '<init>');
+		code.should.match(/return HyperloopJavaNewObjectToJSValue\(ctx,result,java_lang_Object_ToJSValue,exception\);/);
+		code.should.not.match(/HyperloopJavaObjectToJSValue/);
+		state.externs.indexOf('EXPORTAPI JSValueRef java_lang_Object_ToJSValue(JSContextRef,jobject,JSValueRef *);').should.not.be.equal(-1);
+	});
+
+	it('method result is looked up in the identity cache',function() {
+		var state = {externs:[]},
+			method = {name:'getSelf', instance:false, args:[], returnType:'java.lang.Object', signature:'()Ljava/lang/Object;'},
+			code = library.generateMethod({platform:'java'}, metabase, state, '\t', 'object', 'java.lang.Object', method, 'getSelf');
+		code.should.match(/return HyperloopJavaObjectToJSValue\(ctx,result,java_lang_Object_ToJSValue,exception\);/);
+		code.should.not.match(/HyperloopJavaNewObjectToJSValue/);
+	});
+
+	it('custom class callback wraps this and super through the identity cache',function() {
+		var state = {
+				custom_classes: {
+					'com.test.app.MyClass': {
+						superClass: 'java.lang.Object',
+						methods: {
+							run: [{name:'run', hasAction:true, args:[], returnType:'void', signature:'()V'}]
+						}
+					}
+				}
+			},
+			code = [];
+		library.prepareClass({platform:'java'}, metabase, state, 'com.test.app.MyClass', code);
+		code = code.join('\n');
+		code.should.match(/auto instance = JSValueToObject\(ctx, HyperloopJavaObjectToJSValue\(ctx, obj, com_test_app_MyClass_ToJSValue, exception\), exception\);/);
+		code.should.match(/if \(!JSObjectHasProperty\(ctx, instance, superProperty\)\)\n\t\{\n\t\tauto superObj = HyperloopJavaObjectToJSValue\(ctx, obj, java_lang_Object_ToJSValue, exception\);\n\t\tJSObjectSetProperty\(ctx, instance, superProperty, superObj,/);
+		code.should.not.match(/= com_test_app_MyClass_ToJSValue\(ctx, obj/);
+		code.should.not.match(/= java_lang_Object_ToJSValue\(ctx, obj/);
+	});
+
+	it('benchmark and identity cache options add compiler flags',function() {
+		library.getCFlags({}).should.eql([]);
+		library.getCFlags({cflags:['-DFOO'], benchmark:true, 'identity-cache':'1024'}).should.eql(['-DFOO','-DHL_JAVA_BENCHMARK','-DHL_JAVA_IDENTITY_CACHE_SIZE=1024']);
+	});
+
+});
@@ -156,5 +156,31 @@ describe('Java types', function(){
 		type.toCast().should.be.equal('jbooleanArray');
 	});
 
+	it('toJSBody object',function() {
+		typelib.metabase = {
+			classes: {
+				"java.lang.Object": {}
+			}
+		};
+		var type = typelib.resolveType('java.lang.Object'),
+			declare = [];
+		type.toJSBody('result',[],[],declare).should.be.equal('HyperloopJavaObjectToJSValue(ctx,result,java_lang_Object_ToJSValue,exception)');
+		declare.indexOf('EXPORTAPI JSValueRef java_lang_Object_ToJSValue(JSContextRef,jobject,JSValueRef *);').should.not.be.equal(-1);
+		type = typelib.resolveType('int');
+		type.toJSBody('result',[],[],[]).should.not.match(/HyperloopJavaObjectToJSValue/);
+	});
+
+	it('toNewInstanceJSBody object',function() {
+		typelib.metabase = {
+			classes: {
+				"java.lang.Object": {}
+			}
+		};
+		var type = typelib.resolveType('java.lang.Object');
+		type.toNewInstanceJSBody('result',[],[],[]).should.be.equal('HyperloopJavaNewObjectToJSValue(ctx,result,java_lang_Object_ToJSValue,exception)');
+		type = typelib.resolveType('int');
+		type.toNewInstanceJSBody('result',[],[],[]).should.not.match(/HyperloopJavaNewObjectToJSValue/);
+	});
+
 });
 
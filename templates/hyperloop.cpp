@@ -4,6 +4,11 @@
 
 #include <jni.h>
 #include <iostream>
+#include <list>
+#include <iterator>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
 
 static JavaVM *_vm  = nullptr;
 
@@ -103,11 +108,13 @@ std::string to_string(T value)
 #ifdef __ANDROID__
 #define JAVA_LANG_BOOLEAN_SIG "java/lang/Boolean"
 #define JAVA_LANG_DOUBLE_SIG "java/lang/Double"
+#define JAVA_LANG_SYSTEM_SIG "java/lang/System"
 #define JAVA_SIG_S ""
 #define JAVA_SIG_E ""
 #else
 #define JAVA_LANG_BOOLEAN_SIG "Ljava/lang/Boolean;"
 #define JAVA_LANG_DOUBLE_SIG "Ljava/lang/Double;"
+#define JAVA_LANG_SYSTEM_SIG "Ljava/lang/System;"
 #define JAVA_SIG_S "L"
 #define JAVA_SIG_E ";"
 #endif
@@ -115,6 +122,23 @@ std::string to_string(T value)
 namespace Hyperloop
 {
 typedef Hyperloop::NativeObject<jobject> * NativeObjectJava;
+
+#ifdef HL_JAVA_BENCHMARK
+/**
+ * bridge counters reported by Hyperloop_Java_Stats, only compiled in by the benchmark command
+ */
+static struct
+{
+    std::atomic<long long> nativeObjects{0};
+    std::atomic<long long> globalRefs{0};
+    std::atomic<long long> identityCacheHits{0};
+} _stats;
+#define HL_JAVA_STAT_INCREMENT(name) Hyperloop::_stats.name++;
+#define HL_JAVA_STAT_DECREMENT(name) Hyperloop::_stats.name--;
+#else
+#define HL_JAVA_STAT_INCREMENT(name)
+#define HL_JAVA_STAT_DECREMENT(name)
+#endif
     
 static NativeObjectJava ToNativeObjectJava(void* p) {
     return reinterpret_cast<NativeObjectJava>(p);
@@ -129,6 +153,7 @@ void Hyperloop::NativeObject<jobject>::release()
     }
     Hyperloop::JNIEnv env;
     env->DeleteGlobalRef(this->object);
+    HL_JAVA_STAT_DECREMENT(globalRefs)
 }
 
 template<>
@@ -140,6 +165,8 @@ void Hyperloop::NativeObject<jobject>::retain()
     }
     Hyperloop::JNIEnv env;
     this->object = env->NewGlobalRef(this->object);
+    HL_JAVA_STAT_INCREMENT(nativeObjects)
+    HL_JAVA_STAT_INCREMENT(globalRefs)
 }
 
 template<>
@@ -468,7 +495,7 @@ EXPORTAPI JSValueRef JavaObjectArray_ToJSValue(JSContextRef ctx, jobject instanc
 
     for (auto i = 0; i < length; i++) {
         auto object = env->GetObjectArrayElement(array, i);
-        values[i] = java_lang_Object_ToJSValue(ctx, object, exception);
+        values[i] = HyperloopJavaObjectToJSValue(ctx, object, java_lang_Object_ToJSValue, exception);
         env->DeleteLocalRef(object);
     }
 
@@ -536,6 +563,244 @@ EXPORTAPI jobject JSValueTo_jobject(JSContextRef ctx, JSValueRef value, JSValueR
     return nullptr;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Java object identity cache
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * size of the identity cache. off by default: cached wrappers are protected
+ * (JSC's C API has no weak references and finalizes lazily, so an unprotected
+ * wrapper could be handed out after it died) which keeps their Java objects
+ * alive until they're evicted. build with -DHL_JAVA_IDENTITY_CACHE_SIZE=<n>
+ * (or `hyperloop benchmark --identity-cache=<n>`) to enable it.
+ */
+#ifndef HL_JAVA_IDENTITY_CACHE_SIZE
+#define HL_JAVA_IDENTITY_CACHE_SIZE 0
+#endif
+
+#if HL_JAVA_IDENTITY_CACHE_SIZE > 0
+namespace Hyperloop
+{
+struct JavaIdentityEntry
+{
+    JSObjectRef wrapper;
+    jobject object;
+    HyperloopJavaToJSValueFunction toJSValue;
+    jint hash;
+};
+
+typedef std::list<JavaIdentityEntry> JavaIdentityList;
+
+/**
+ * wrappers keyed by System.identityHashCode, most recently used first in
+ * _identityOrder. wrappers are protected while they are in the map so the
+ * global ref they hold (and compare against) stays valid; the least recently
+ * used one is released once the map is full.
+ *
+ * the map is shared by the JS thread and Java threads calling back into JS.
+ * JSC calls take the JSLock, so they're never made while holding _identityMutex.
+ */
+static std::mutex _identityMutex;
+static JavaIdentityList _identityOrder;
+static std::unordered_multimap<jint, JavaIdentityList::iterator> _identityMap;
+static std::once_flag _identityHashCodeOnce;
+static jclass _systemClass = nullptr;
+static jmethodID _identityHashCodeId = nullptr;
+
+static jint IdentityHashCode(Hyperloop::JNIEnv &env, jobject object)
+{
+    std::call_once(_identityHashCodeOnce, [&env]() {
+        auto cls = env->FindClass(JAVA_LANG_SYSTEM_SIG);
+        _systemClass = static_cast<jclass>(env->NewGlobalRef(cls));
+        env->DeleteLocalRef(cls);
+        _identityHashCodeId = env->GetStaticMethodID(_systemClass, "identityHashCode", "(Ljava/lang/Object;)I");
+    });
+    return env->CallStaticIntMethod(_systemClass, _identityHashCodeId, object);
+}
+
+/**
+ * find a live wrapper, must be called with _identityMutex held
+ */
+static JavaIdentityList::iterator FindIdentityEntry(Hyperloop::JNIEnv &env, jint hash, jobject object, HyperloopJavaToJSValueFunction toJSValue)
+{
+    auto range = _identityMap.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto entry = it->second;
+        if (entry->toJSValue == toJSValue && env->IsSameObject(entry->object, object) == JNI_TRUE)
+        {
+            return entry;
+        }
+    }
+    return _identityOrder.end();
+}
+
+/**
+ * remove an entry from the map, must be called with _identityMutex held
+ */
+static void EraseIdentityEntry(JavaIdentityList::iterator entry)
+{
+    auto range = _identityMap.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == entry)
+        {
+            _identityMap.erase(it);
+            break;
+        }
+    }
+    _identityOrder.erase(entry);
+}
+
+/**
+ * wrap instance and add the wrapper to the map. returns the wrapper another
+ * thread added in the meantime if there is one.
+ */
+static JSValueRef InsertIdentityEntry(JSContextRef ctx, Hyperloop::JNIEnv &env, jint hash, jobject instance, HyperloopJavaToJSValueFunction toJSValue, JSValueRef *exception)
+{
+    auto value = toJSValue(ctx, instance, exception);
+    if (value == nullptr || !JSValueIsObject(ctx, value))
+    {
+        return value;
+    }
+    auto wrapper = JSValueToObject(ctx, value, nullptr);
+    auto p = wrapper == nullptr ? nullptr : JSObjectGetPrivate(wrapper);
+    if (p == nullptr)
+    {
+        return value;
+    }
+    JSValueProtect(ctx, wrapper);
+
+    JSObjectRef existing = nullptr;
+    JSObjectRef evicted = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_identityMutex);
+        auto entry = FindIdentityEntry(env, hash, instance, toJSValue);
+        if (entry != _identityOrder.end())
+        {
+            existing = entry->wrapper;
+        }
+        else
+        {
+            if (_identityOrder.size() >= HL_JAVA_IDENTITY_CACHE_SIZE)
+            {
+                auto last = std::prev(_identityOrder.end());
+                evicted = last->wrapper;
+                EraseIdentityEntry(last);
+            }
+            _identityOrder.push_front(JavaIdentityEntry{wrapper, ToNativeObjectJava(p)->getObject(), toJSValue, hash});
+            _identityMap.insert(std::make_pair(hash, _identityOrder.begin()));
+        }
+    }
+    if (existing != nullptr)
+    {
+        JSValueUnprotect(ctx, wrapper);
+        return existing;
+    }
+    if (evicted != nullptr)
+    {
+        JSValueUnprotect(ctx, evicted);
+    }
+    return value;
+}
+
+} // namespace
+#endif
+
+/**
+ * return the JS wrapper for a Java object, reusing the live wrapper if the
+ * same Java object was already converted with the same ToJSValue function
+ */
+EXPORTAPI JSValueRef HyperloopJavaObjectToJSValue(JSContextRef ctx, jobject instance, HyperloopJavaToJSValueFunction toJSValue, JSValueRef *exception)
+{
+#if HL_JAVA_IDENTITY_CACHE_SIZE > 0
+    if (instance == nullptr)
+    {
+        return toJSValue(ctx, instance, exception);
+    }
+    Hyperloop::JNIEnv env;
+    auto hash = Hyperloop::IdentityHashCode(env, instance);
+    {
+        std::lock_guard<std::mutex> lock(Hyperloop::_identityMutex);
+        auto entry = Hyperloop::FindIdentityEntry(env, hash, instance, toJSValue);
+        if (entry != Hyperloop::_identityOrder.end())
+        {
+            Hyperloop::_identityOrder.splice(Hyperloop::_identityOrder.begin(), Hyperloop::_identityOrder, entry);
+            HL_JAVA_STAT_INCREMENT(identityCacheHits)
+            return entry->wrapper;
+        }
+    }
+    return Hyperloop::InsertIdentityEntry(ctx, env, hash, instance, toJSValue, exception);
+#else
+    return toJSValue(ctx, instance, exception);
+#endif
+}
+
+/**
+ * return the JS wrapper for a Java object that was just created. it can't
+ * have a wrapper yet so there is no lookup, but the new wrapper is added so
+ * later conversions of the same object (i.e. methods returning this) reuse it
+ */
+EXPORTAPI JSValueRef HyperloopJavaNewObjectToJSValue(JSContextRef ctx, jobject instance, HyperloopJavaToJSValueFunction toJSValue, JSValueRef *exception)
+{
+#if HL_JAVA_IDENTITY_CACHE_SIZE > 0
+    if (instance == nullptr)
+    {
+        return toJSValue(ctx, instance, exception);
+    }
+    Hyperloop::JNIEnv env;
+    auto hash = Hyperloop::IdentityHashCode(env, instance);
+    return Hyperloop::InsertIdentityEntry(ctx, env, hash, instance, toJSValue, exception);
+#else
+    return toJSValue(ctx, instance, exception);
+#endif
+}
+
+/**
+ * release every cached wrapper. must be called before the global context
+ * they belong to is released.
+ */
+EXPORTAPI void HyperloopJavaClearIdentityCache(JSContextRef ctx)
+{
+#if HL_JAVA_IDENTITY_CACHE_SIZE > 0
+    Hyperloop::JavaIdentityList entries;
+    {
+        std::lock_guard<std::mutex> lock(Hyperloop::_identityMutex);
+        entries.swap(Hyperloop::_identityOrder);
+        Hyperloop::_identityMap.clear();
+    }
+    for (auto &entry : entries)
+    {
+        JSValueUnprotect(ctx, entry.wrapper);
+    }
+#endif
+}
+
+#ifdef HL_JAVA_BENCHMARK
+namespace Hyperloop
+{
+static void SetStatProperty(JSContextRef ctx, JSObjectRef object, const char *name, long long value, JSValueRef *exception)
+{
+    auto property = JSStringCreateWithUTF8CString(name);
+    JSObjectSetProperty(ctx, object, property, JSValueMakeNumber(ctx, static_cast<double>(value)), kJSPropertyAttributeNone, exception);
+    JSStringRelease(property);
+}
+} // namespace
+
+/**
+ * returns the bridge counters as a JS object:
+ * { nativeObjects: wrapped Java objects created, globalRefs: live global refs, identityCacheHits: reused wrappers }
+ */
+EXPORTAPI JSValueRef Hyperloop_Java_Stats(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception)
+{
+    auto result = JSObjectMake(ctx, nullptr, nullptr);
+    Hyperloop::SetStatProperty(ctx, result, "nativeObjects", Hyperloop::_stats.nativeObjects.load(), exception);
+    Hyperloop::SetStatProperty(ctx, result, "globalRefs", Hyperloop::_stats.globalRefs.load(), exception);
+    Hyperloop::SetStatProperty(ctx, result, "identityCacheHits", Hyperloop::_stats.identityCacheHits.load(), exception);
+    return result;
+}
+#endif
+
 EXPORTAPI JSValueRef Hyperloop_Binary_InstanceOf(JSContextRef ctx, JSObjectRef function, JSObjectRef thisObject, size_t argumentCount, const JSValueRef arguments[], JSValueRef* exception) {
     if (argumentCount < 2)
     {
@@ -600,4 +865,11 @@ EXPORTAPI void JNICALL Java_org_appcelerator_hyperloop_Hyperloop_loadApp
         LOGD("Java_app_loadApp raised Java exception");
     }
 }
+
+EXPORTAPI void JNICALL Java_org_appcelerator_hyperloop_Hyperloop_unloadApp
+   (JNIEnv *env, jclass jcls)
+{
+    LOGD("Java_app_unloadApp")
+    HyperloopJavaClearIdentityCache(HyperloopGlobalContext());
+}
 ///////////////////////////////////////////////////////////////////////////////////////////////
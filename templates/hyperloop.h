@@ -68,6 +68,12 @@ class JNIEnv
 
 EXPORTAPI jobject JSValueTo_JavaObject(JSContextRef ctx, JSValueRef value, JSValueRef *exception);
 
+/* Java object identity cache */
+typedef JSValueRef (*HyperloopJavaToJSValueFunction)(JSContextRef ctx, jobject instance, JSValueRef *exception);
+EXPORTAPI JSValueRef HyperloopJavaObjectToJSValue(JSContextRef ctx, jobject instance, HyperloopJavaToJSValueFunction toJSValue, JSValueRef *exception);
+EXPORTAPI JSValueRef HyperloopJavaNewObjectToJSValue(JSContextRef ctx, jobject instance, HyperloopJavaToJSValueFunction toJSValue, JSValueRef *exception);
+EXPORTAPI void HyperloopJavaClearIdentityCache(JSContextRef ctx);
+
 /* Java array support */
 EXPORTAPI JSValueRef JavaBooleanArray_ToJSValue(JSContextRef ctx, jbooleanArray instance, JSValueRef *exception);
 EXPORTAPI JSValueRef JavaByteArray_ToJSValue(JSContextRef ctx, jbyteArray instance, JSValueRef *exception);
@@ -13,6 +13,7 @@ public class app
 			System.out.println("---> Executing App");
 			org.appcelerator.hyperloop.Hyperloop.loadApp();
 			System.out.println("---> Executed App");
+			org.appcelerator.hyperloop.Hyperloop.unloadApp();
 		}
 		catch (Throwable ex) {
 			System.err.println("--> Error: "+ex);
@@ -2,4 +2,8 @@ package org.appcelerator.hyperloop;
 
 public class Hyperloop {
 	public static native void loadApp();
+	/**
+	 * releases the JS wrappers held by the native layer. call before the JS context goes away.
+	 */
+	public static native void unloadApp();
 }